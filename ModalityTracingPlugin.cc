@@ -1,5 +1,15 @@
 #include <cstdlib>
+#include <ctime>
 #include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <gz/plugin/Register.hh>
 #include <gz/sim/Util.hh>
@@ -50,6 +60,11 @@ const char SDF_TRACE_CONTACT_COLLISION[] = "contact_collision";
 const char SDF_STEP_SIZE[] = "step_size";
 const char SDF_COLLISION_NAME[] = "collision_name";
 const char SDF_SAMPLE_N_ITERS[] = "sample_n_iters";
+const char SDF_BATCH_N_STEPS[] = "batch_n_steps";
+const char SDF_BATCH_MAX_BYTES[] = "batch_max_bytes";
+const char SDF_BATCH_MAX_SIM_TIME[] = "batch_max_sim_time";
+const char SDF_BATCH_MAX_IN_FLIGHT[] = "batch_max_in_flight";
+const char SDF_INGEST_STATS[] = "ingest_stats";
 
 const char EVENT_NAME_POSE[] = "pose";
 const char EVENT_NAME_LINEAR_VEL[] = "linear_velocity";
@@ -130,10 +145,84 @@ static inline uint64_t dur_to_ns(std::chrono::steady_clock::duration dur)
     return ts_ns;
 }
 
+static inline uint64_t thread_cpu_ns(void)
+{
+    struct timespec ts;
+    (void) clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (((uint64_t) ts.tv_sec) * NS_PER_SEC) + (uint64_t) ts.tv_nsec;
+}
+
+namespace
+{
+// Attributes shared by every event produced in a single PostUpdate step
+struct StepAttrs
+{
+    uint64_t step{0};
+    uint64_t timestamp_ns{0};
+    uint64_t sim_time_ns{0};
+    uint64_t wall_clock_time_ns{0};
+    uint64_t iterations{0};
+};
+
+// An event captured during PostUpdate, owning all of its attribute values so
+// it can be sent immediately or held in the batch and sent later
+struct PendingEvent
+{
+    uint64_t ordering{0};
+    const char *name{NULL};
+    StepAttrs step;
+    double x{0.0};
+    double y{0.0};
+    double z{0.0};
+    double roll{0.0};
+    double pitch{0.0};
+    double yaw{0.0};
+    std::string collision_name;
+    gz::sim::Entity other_collision_entity{gz::sim::kNullEntity};
+    // Slice of event_attrs to send, see EVENT_ATTR_KEYS ordering
+    int first_attr{EID_IDX_NAME};
+    int num_attrs{0};
+};
+
+// Accumulates the calling thread's CPU time into total_ns while enabled is
+// set at the end of the scope
+class ThreadCpuTimer
+{
+    public: ThreadCpuTimer(const bool &_enabled, uint64_t &_total_ns):
+        enabled(_enabled), total_ns(_total_ns), start_ns(_enabled ? thread_cpu_ns() : 0)
+    {
+    }
+
+    public: ~ThreadCpuTimer()
+    {
+        if(this->enabled)
+        {
+            this->total_ns += thread_cpu_ns() - this->start_ns;
+        }
+    }
+
+    private:
+        const bool &enabled;
+        uint64_t &total_ns;
+        const uint64_t start_ns;
+};
+}
+
 class modality_gz::TracingPrivate
 {
+    public: bool LogClientError(int err, const char *msg);
     public: void HandleClientError(int err, const char *msg);
     public: void DeInit(void);
+    public: PendingEvent &NextEvent(void);
+    public: void CommitEvent(PendingEvent &ev);
+    public: bool SendEvent(const PendingEvent &ev);
+    public: void FlushBatch(void);
+    public: void CheckBatchThresholds(const gz::sim::UpdateInfo &info);
+    public: bool BatchingEnabled(void) const;
+    public: void StartSender(void);
+    public: void StopSender(void);
+    public: void SenderLoop(void);
+    public: void ReportStats(void);
 
     public:
         std::chrono::steady_clock::duration current_time;
@@ -146,8 +235,48 @@ class modality_gz::TracingPrivate
         bool trace_linear_vel{true};
         bool trace_contact_collision{false};
         bool allow_insecure_tls{true};
+        bool ingest_stats{false};
         uint64_t sample_n_iters{0};
 
+        // Batching thresholds, a value of 0 disables the respective threshold.
+        // Events are sent immediately when all thresholds are disabled.
+        uint64_t batch_n_steps{0};
+        uint64_t batch_max_bytes{0};
+        std::chrono::steady_clock::duration batch_max_sim_time{0};
+        // Batches queued or being sent before PostUpdate blocks on the sender
+        uint64_t batch_max_in_flight{2};
+
+        StepAttrs step_attrs;
+        PendingEvent scratch_event;
+        std::vector<PendingEvent> batch;
+        uint64_t batch_bytes{0};
+        // Sim iterations and time of the step that started the current batch
+        uint64_t batch_start_iters{0};
+        std::chrono::steady_clock::duration batch_start_time{0};
+        // Sim iterations and time of the last unpaused step
+        uint64_t last_step_iters{0};
+        std::chrono::steady_clock::duration last_step_time{0};
+
+        // Full batches are handed to the sender thread, which owns the
+        // client while it runs. Drained batches are returned on the free
+        // list so their allocations get reused.
+        std::thread sender;
+        std::mutex sender_mutex;
+        std::condition_variable sender_cv;
+        std::deque<std::vector<PendingEvent>> sender_queue;
+        std::vector<std::vector<PendingEvent>> sender_free;
+        uint64_t sender_in_flight{0};
+        bool sender_stop{false};
+        std::atomic<bool> sender_failed{false};
+
+        // Step of the event whose step attributes are currently set
+        uint64_t sent_step{0};
+
+        // Ingest stats, only collected with ingest_stats enabled
+        uint64_t events_sent{0};
+        uint64_t post_update_cpu_ns{0};
+        uint64_t sender_cpu_ns{0};
+
         std::string auth_token;
         std::string timeline_name;
         std::string ingest_parent_url{"modality-ingest://localhost:14182"};
@@ -158,6 +287,7 @@ class modality_gz::TracingPrivate
         struct modality_big_int link_entity;
         struct modality_big_int model_entity;
         struct modality_big_int sim_iters;
+        struct modality_big_int collision_entity_id;
         uint64_t ordering{0};
         struct modality_runtime *rt{NULL};
         struct modality_ingest_client *client{NULL};
@@ -167,19 +297,34 @@ class modality_gz::TracingPrivate
         modality_attr event_attrs[NUM_EVENT_ATTRS];
 };
 
-void TracingPrivate::HandleClientError(int err, const char *msg)
+bool TracingPrivate::LogClientError(int err, const char *msg)
 {
     if(err != MODALITY_ERROR_OK)
     {
         gzerr << "A Modality client API call returned a non-zero error code (" << err << ")" << " : " << msg << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void TracingPrivate::HandleClientError(int err, const char *msg)
+{
+    if(!this->LogClientError(err, msg))
+    {
         this->DeInit();
     }
 }
 
 void TracingPrivate::DeInit(void)
 {
+    // Drain the sender before the client is torn down
+    this->FlushBatch();
+    this->StopSender();
+    this->sender_failed = false;
+
     if(this->client)
     {
+        this->ReportStats();
         (void) modality_ingest_client_close_timeline(this->client);
     }
     modality_ingest_client_free(this->client);
@@ -187,6 +332,294 @@ void TracingPrivate::DeInit(void)
     this->rt = NULL;
     this->client = NULL;
     this->tracing_enabled = false;
+    this->ingest_stats = false;
+}
+
+void TracingPrivate::ReportStats(void)
+{
+    if(!this->ingest_stats)
+    {
+        return;
+    }
+
+    const double post_update_secs = this->post_update_cpu_ns / (double) NS_PER_SEC;
+    gzmsg << "Modality ingest stats: " << this->ordering << " events traced, "
+        << this->events_sent << " events sent" << std::endl;
+    if(post_update_secs > 0.0)
+    {
+        gzmsg << "  PostUpdate thread: " << post_update_secs << " s CPU, "
+            << (this->ordering / post_update_secs) << " events/s per core" << std::endl;
+    }
+
+    const double sender_secs = this->sender_cpu_ns / (double) NS_PER_SEC;
+    if(sender_secs > 0.0)
+    {
+        gzmsg << "  Sender thread: " << sender_secs << " s CPU, "
+            << (this->events_sent / sender_secs) << " events/s per core" << std::endl;
+    }
+}
+
+bool TracingPrivate::BatchingEnabled(void) const
+{
+    return (this->batch_n_steps != 0)
+        || (this->batch_max_bytes != 0)
+        || (this->batch_max_sim_time != std::chrono::steady_clock::duration::zero());
+}
+
+PendingEvent &TracingPrivate::NextEvent(void)
+{
+    PendingEvent &ev = this->sender.joinable() ? this->batch.emplace_back() : this->scratch_event;
+    ev.ordering = this->ordering;
+    ev.step = this->step_attrs;
+    return ev;
+}
+
+void TracingPrivate::CommitEvent(PendingEvent &ev)
+{
+    if(this->sender.joinable())
+    {
+        this->batch_bytes += sizeof(PendingEvent) + ev.collision_name.size();
+    }
+    else if(this->client && !this->SendEvent(ev))
+    {
+        this->DeInit();
+    }
+}
+
+bool TracingPrivate::SendEvent(const PendingEvent &ev)
+{
+    int err;
+
+    err = modality_attr_val_set_string(&this->event_attrs[EID_IDX_NAME].val, ev.name);
+    if(!this->LogClientError(err, ERR_EVENT_ATTR_VAL))
+    {
+        return false;
+    }
+
+    // Events of the same step share these, only set them when the step changes
+    if(ev.step.step != this->sent_step)
+    {
+        err = modality_attr_val_set_timestamp(&this->event_attrs[EID_IDX_TIMESTAMP].val, ev.step.timestamp_ns);
+        if(!this->LogClientError(err, "Failed to set event timestamp attribute value"))
+        {
+            return false;
+        }
+        err = modality_attr_val_set_timestamp(&this->event_attrs[EID_IDX_SIM_TIME].val, ev.step.sim_time_ns);
+        if(!this->LogClientError(err, "Failed to set event sim time attribute value"))
+        {
+            return false;
+        }
+        err = modality_attr_val_set_timestamp(&this->event_attrs[EID_IDX_WALL_CLOCK_TIME].val, ev.step.wall_clock_time_ns);
+        if(!this->LogClientError(err, "Failed to set event wall clock time attribute value"))
+        {
+            return false;
+        }
+
+        err = modality_big_int_set(&this->sim_iters, ev.step.iterations, 0);
+        if(!this->LogClientError(err, "Failed to set sim iterations big int value"))
+        {
+            return false;
+        }
+        err = modality_attr_val_set_big_int(&this->event_attrs[EID_IDX_ITERATIONS].val, &this->sim_iters);
+        if(!this->LogClientError(err, ERR_EVENT_ATTR_VAL))
+        {
+            return false;
+        }
+
+        this->sent_step = ev.step.step;
+    }
+
+    if(ev.first_attr == EID_IDX_COLLISION_NAME)
+    {
+        err = modality_attr_val_set_string(&this->event_attrs[EID_IDX_COLLISION_NAME].val, ev.collision_name.c_str());
+        if(!this->LogClientError(err, ERR_EVENT_ATTR_VAL))
+        {
+            return false;
+        }
+
+        err = modality_big_int_set(&this->collision_entity_id, ev.other_collision_entity, 0);
+        if(!this->LogClientError(err, "Failed to set contact collision entity big int value"))
+        {
+            return false;
+        }
+        err = modality_attr_val_set_big_int(&this->event_attrs[EID_IDX_COLLISION_ENTITY].val, &this->collision_entity_id);
+        if(!this->LogClientError(err, ERR_EVENT_ATTR_VAL))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        err = modality_attr_val_set_float(&this->event_attrs[EID_IDX_X].val, ev.x);
+        if(!this->LogClientError(err, ERR_EVENT_ATTR_VAL))
+        {
+            return false;
+        }
+        err = modality_attr_val_set_float(&this->event_attrs[EID_IDX_Y].val, ev.y);
+        if(!this->LogClientError(err, ERR_EVENT_ATTR_VAL))
+        {
+            return false;
+        }
+        err = modality_attr_val_set_float(&this->event_attrs[EID_IDX_Z].val, ev.z);
+        if(!this->LogClientError(err, ERR_EVENT_ATTR_VAL))
+        {
+            return false;
+        }
+
+        if(ev.num_attrs == NUM_EVENT_ATTRS_POSE)
+        {
+            err = modality_attr_val_set_float(&this->event_attrs[EID_IDX_ROLL].val, ev.roll);
+            if(!this->LogClientError(err, ERR_EVENT_ATTR_VAL))
+            {
+                return false;
+            }
+            err = modality_attr_val_set_float(&this->event_attrs[EID_IDX_PITCH].val, ev.pitch);
+            if(!this->LogClientError(err, ERR_EVENT_ATTR_VAL))
+            {
+                return false;
+            }
+            err = modality_attr_val_set_float(&this->event_attrs[EID_IDX_YAW].val, ev.yaw);
+            if(!this->LogClientError(err, ERR_EVENT_ATTR_VAL))
+            {
+                return false;
+            }
+        }
+    }
+
+    err = modality_ingest_client_event(
+            this->client,
+            ev.ordering,
+            0,
+            &this->event_attrs[ev.first_attr],
+            ev.num_attrs);
+    if(!this->LogClientError(err, ERR_EVENT_SEND))
+    {
+        return false;
+    }
+
+    this->events_sent += 1;
+    return true;
+}
+
+void TracingPrivate::FlushBatch(void)
+{
+    if(this->batch.empty())
+    {
+        return;
+    }
+
+    if(!this->sender.joinable())
+    {
+        this->batch.clear();
+        this->batch_bytes = 0;
+        return;
+    }
+
+    std::vector<PendingEvent> next;
+    {
+        std::unique_lock<std::mutex> lock(this->sender_mutex);
+
+        // Backpressure, wait for the sender to hand back a drained batch
+        // rather than queueing up the whole run when the client falls behind
+        this->sender_cv.wait(lock, [this]{ return this->sender_in_flight < this->batch_max_in_flight; });
+
+        this->sender_queue.push_back(std::move(this->batch));
+        this->sender_in_flight += 1;
+        if(!this->sender_free.empty())
+        {
+            next.swap(this->sender_free.back());
+            this->sender_free.pop_back();
+        }
+    }
+    this->sender_cv.notify_all();
+
+    this->batch.swap(next);
+    this->batch_bytes = 0;
+}
+
+void TracingPrivate::CheckBatchThresholds(const gz::sim::UpdateInfo &info)
+{
+    // Sim time going backwards (e.g. a world reset) also ends the batch
+    bool rewound = (info.simTime < this->last_step_time)
+        || (info.iterations < this->last_step_iters);
+    this->last_step_time = info.simTime;
+    this->last_step_iters = info.iterations;
+
+    if(this->batch.empty())
+    {
+        return;
+    }
+    bool steps_reached = (this->batch_n_steps != 0)
+        && ((info.iterations - this->batch_start_iters) >= this->batch_n_steps);
+    bool bytes_reached = (this->batch_max_bytes != 0)
+        && (this->batch_bytes >= this->batch_max_bytes);
+    bool deadline_reached = (this->batch_max_sim_time != std::chrono::steady_clock::duration::zero())
+        && ((info.simTime - this->batch_start_time) >= this->batch_max_sim_time);
+
+    if(rewound || steps_reached || bytes_reached || deadline_reached)
+    {
+        this->FlushBatch();
+    }
+}
+
+void TracingPrivate::StartSender(void)
+{
+    this->sender_stop = false;
+    this->sender = std::thread(&TracingPrivate::SenderLoop, this);
+}
+
+void TracingPrivate::StopSender(void)
+{
+    if(!this->sender.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->sender_mutex);
+        this->sender_stop = true;
+    }
+    this->sender_cv.notify_all();
+    this->sender.join();
+}
+
+void TracingPrivate::SenderLoop(void)
+{
+    std::unique_lock<std::mutex> lock(this->sender_mutex);
+    for(;;)
+    {
+        this->sender_cv.wait(lock, [this]{ return this->sender_stop || !this->sender_queue.empty(); });
+        if(this->sender_queue.empty())
+        {
+            // Stopped and drained
+            return;
+        }
+
+        std::vector<PendingEvent> events = std::move(this->sender_queue.front());
+        this->sender_queue.pop_front();
+        lock.unlock();
+
+        // Errors can't DeInit from here, PostUpdate does it on the next step.
+        // Remaining events are dropped like they are once the client is gone.
+        if(!this->sender_failed)
+        {
+            ThreadCpuTimer timer(this->ingest_stats, this->sender_cpu_ns);
+            for(const auto &ev : events)
+            {
+                if(!this->SendEvent(ev))
+                {
+                    this->sender_failed = true;
+                    break;
+                }
+            }
+        }
+
+        events.clear();
+        lock.lock();
+        this->sender_free.push_back(std::move(events));
+        this->sender_in_flight -= 1;
+        this->sender_cv.notify_all();
+    }
 }
 
 Tracing::Tracing(): data_ptr(std::make_unique < TracingPrivate > ())
@@ -304,6 +737,25 @@ void Tracing::Configure(
 
         auto sample_n_iters = sdf->Get<uint64_t>(SDF_SAMPLE_N_ITERS, 0);
         this->data_ptr->sample_n_iters = sample_n_iters.first;
+
+        auto ingest_stats = sdf->Get<bool>(SDF_INGEST_STATS, false);
+        this->data_ptr->ingest_stats = ingest_stats.first;
+
+        auto batch_n_steps = sdf->Get<uint64_t>(SDF_BATCH_N_STEPS, 0);
+        this->data_ptr->batch_n_steps = batch_n_steps.first;
+
+        auto batch_max_bytes = sdf->Get<uint64_t>(SDF_BATCH_MAX_BYTES, 0);
+        this->data_ptr->batch_max_bytes = batch_max_bytes.first;
+
+        auto batch_max_sim_time = sdf->Get<double>(SDF_BATCH_MAX_SIM_TIME, 0.0);
+        if(batch_max_sim_time.first > 0.0)
+        {
+            this->data_ptr->batch_max_sim_time = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(batch_max_sim_time.first));
+        }
+
+        auto batch_max_in_flight = sdf->Get<uint64_t>(SDF_BATCH_MAX_IN_FLIGHT, 2);
+        this->data_ptr->batch_max_in_flight = std::max<uint64_t>(batch_max_in_flight.first, 1);
     }
 
     // Setup the client if config checks out
@@ -414,20 +866,42 @@ void Tracing::Configure(
         err = modality_ingest_client_timeline_metadata(this->data_ptr->client, this->data_ptr->timeline_attrs, NUM_TIMELINE_ATTRS);
         this->data_ptr->HandleClientError(err, "Failed to send timeline metadata");
     }
+
+    if(this->data_ptr->tracing_enabled && this->data_ptr->BatchingEnabled())
+    {
+        this->data_ptr->StartSender();
+    }
 }
 
 void Tracing::PostUpdate(
         const gz::sim::UpdateInfo &info,
         const gz::sim::EntityComponentManager &ecm)
 {
-    int err;
+    ThreadCpuTimer timer(this->data_ptr->ingest_stats, this->data_ptr->post_update_cpu_ns);
     std::chrono::time_point now = std::chrono::time_point_cast<std::chrono::nanoseconds>(
         std::chrono::system_clock::now()
     );
 
+    if(this->data_ptr->sender_failed && this->data_ptr->tracing_enabled)
+    {
+        this->data_ptr->DeInit();
+    }
+
     bool not_tracing = !this->data_ptr->tracing_enabled || info.paused;
     bool no_data_selected = !(this->data_ptr->trace_pose || this->data_ptr->trace_linear_vel || this->data_ptr->trace_linear_accel);
 
+    if(info.paused)
+    {
+        // Don't hold events back while the simulation is paused
+        this->data_ptr->FlushBatch();
+    }
+    else
+    {
+        // Checked ahead of the early returns below so batched events are not
+        // held back by steps that don't produce any
+        this->data_ptr->CheckBatchThresholds(info);
+    }
+
     if(not_tracing || no_data_selected || (this->data_ptr->current_time == info.simTime))
     {
         // Not tracing or paused
@@ -450,51 +924,34 @@ void Tracing::PostUpdate(
     bool model_is_static = model.Static(ecm);
 
     this->data_ptr->current_time = info.simTime;
-    const uint64_t sim_time_ns = dur_to_ns(info.simTime);
-    const uint64_t wall_clock_time_ns = dur_to_ns(info.realTime);
-
-    std::chrono::duration now_ns = now.time_since_epoch();
-    err = modality_attr_val_set_timestamp(&this->data_ptr->event_attrs[EID_IDX_TIMESTAMP].val, now_ns.count());
-    this->data_ptr->HandleClientError(err, "Failed to set event timestamp attribute value");
-    err = modality_attr_val_set_timestamp(&this->data_ptr->event_attrs[EID_IDX_SIM_TIME].val, sim_time_ns);
-    this->data_ptr->HandleClientError(err, "Failed to set event sim time attribute value");
-    err = modality_attr_val_set_timestamp(&this->data_ptr->event_attrs[EID_IDX_WALL_CLOCK_TIME].val, wall_clock_time_ns);
-    this->data_ptr->HandleClientError(err, "Failed to set event wall clock time attribute value");
-
-    err = modality_big_int_set(&this->data_ptr->sim_iters, info.iterations, 0);
-    this->data_ptr->HandleClientError(err, "Failed to set sim iterations big int value");
-    err = modality_attr_val_set_big_int(&this->data_ptr->event_attrs[EID_IDX_ITERATIONS].val, &this->data_ptr->sim_iters);
-    this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
+    if(this->data_ptr->batch.empty())
+    {
+        this->data_ptr->batch_start_time = info.simTime;
+        this->data_ptr->batch_start_iters = info.iterations;
+    }
+
+    this->data_ptr->step_attrs.step += 1;
+    this->data_ptr->step_attrs.timestamp_ns = now.time_since_epoch().count();
+    this->data_ptr->step_attrs.sim_time_ns = dur_to_ns(info.simTime);
+    this->data_ptr->step_attrs.wall_clock_time_ns = dur_to_ns(info.realTime);
+    this->data_ptr->step_attrs.iterations = info.iterations;
 
     if(this->data_ptr->trace_pose)
     {
         if(auto maybe_pose = link.WorldPose(ecm))
         {
             auto pose = maybe_pose.value();
-            err = modality_attr_val_set_string(&this->data_ptr->event_attrs[EID_IDX_NAME].val, EVENT_NAME_POSE);
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-
-            err = modality_attr_val_set_float(&this->data_ptr->event_attrs[EID_IDX_X].val, pose.X());
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-            err = modality_attr_val_set_float(&this->data_ptr->event_attrs[EID_IDX_Y].val, pose.Y());
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-            err = modality_attr_val_set_float(&this->data_ptr->event_attrs[EID_IDX_Z].val, pose.Z());
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-
-            err = modality_attr_val_set_float(&this->data_ptr->event_attrs[EID_IDX_ROLL].val, pose.Roll());
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-            err = modality_attr_val_set_float(&this->data_ptr->event_attrs[EID_IDX_PITCH].val, pose.Pitch());
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-            err = modality_attr_val_set_float(&this->data_ptr->event_attrs[EID_IDX_YAW].val, pose.Yaw());
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-
-            err = modality_ingest_client_event(
-                    this->data_ptr->client,
-                    this->data_ptr->ordering,
-                    0,
-                    &this->data_ptr->event_attrs[EID_IDX_NAME],
-                    NUM_EVENT_ATTRS_POSE);
-            this->data_ptr->HandleClientError(err, ERR_EVENT_SEND);
+            PendingEvent &ev = this->data_ptr->NextEvent();
+            ev.name = EVENT_NAME_POSE;
+            ev.x = pose.X();
+            ev.y = pose.Y();
+            ev.z = pose.Z();
+            ev.roll = pose.Roll();
+            ev.pitch = pose.Pitch();
+            ev.yaw = pose.Yaw();
+            ev.first_attr = EID_IDX_NAME;
+            ev.num_attrs = NUM_EVENT_ATTRS_POSE;
+            this->data_ptr->CommitEvent(ev);
 
             this->data_ptr->ordering += 1;
 
@@ -515,23 +972,14 @@ void Tracing::PostUpdate(
         if(auto maybe_lin_vel = link.WorldLinearVelocity(ecm))
         {
             auto vel = maybe_lin_vel.value();
-            err = modality_attr_val_set_string(&this->data_ptr->event_attrs[EID_IDX_NAME].val, EVENT_NAME_LINEAR_VEL);
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-
-            err = modality_attr_val_set_float(&this->data_ptr->event_attrs[EID_IDX_X].val, vel.X());
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-            err = modality_attr_val_set_float(&this->data_ptr->event_attrs[EID_IDX_Y].val, vel.Y());
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-            err = modality_attr_val_set_float(&this->data_ptr->event_attrs[EID_IDX_Z].val, vel.Z());
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-
-            err = modality_ingest_client_event(
-                    this->data_ptr->client,
-                    this->data_ptr->ordering,
-                    0,
-                    &this->data_ptr->event_attrs[EID_IDX_NAME],
-                    NUM_EVENT_ATTRS_LINEAR_VEL);
-            this->data_ptr->HandleClientError(err, ERR_EVENT_SEND);
+            PendingEvent &ev = this->data_ptr->NextEvent();
+            ev.name = EVENT_NAME_LINEAR_VEL;
+            ev.x = vel.X();
+            ev.y = vel.Y();
+            ev.z = vel.Z();
+            ev.first_attr = EID_IDX_NAME;
+            ev.num_attrs = NUM_EVENT_ATTRS_LINEAR_VEL;
+            this->data_ptr->CommitEvent(ev);
 
             this->data_ptr->ordering += 1;
 
@@ -552,23 +1000,14 @@ void Tracing::PostUpdate(
         if(auto maybe_lin_accel = link.WorldLinearAcceleration(ecm))
         {
             auto accel = maybe_lin_accel.value();
-            err = modality_attr_val_set_string(&this->data_ptr->event_attrs[EID_IDX_NAME].val, EVENT_NAME_LINEAR_ACCEL);
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-
-            err = modality_attr_val_set_float(&this->data_ptr->event_attrs[EID_IDX_X].val, accel.X());
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-            err = modality_attr_val_set_float(&this->data_ptr->event_attrs[EID_IDX_Y].val, accel.Y());
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-            err = modality_attr_val_set_float(&this->data_ptr->event_attrs[EID_IDX_Z].val, accel.Z());
-            this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-
-            err = modality_ingest_client_event(
-                    this->data_ptr->client,
-                    this->data_ptr->ordering,
-                    0,
-                    &this->data_ptr->event_attrs[EID_IDX_NAME],
-                    NUM_EVENT_ATTRS_LINEAR_ACCEL);
-            this->data_ptr->HandleClientError(err, ERR_EVENT_SEND);
+            PendingEvent &ev = this->data_ptr->NextEvent();
+            ev.name = EVENT_NAME_LINEAR_ACCEL;
+            ev.x = accel.X();
+            ev.y = accel.Y();
+            ev.z = accel.Z();
+            ev.first_attr = EID_IDX_NAME;
+            ev.num_attrs = NUM_EVENT_ATTRS_LINEAR_ACCEL;
+            this->data_ptr->CommitEvent(ev);
 
             this->data_ptr->ordering += 1;
 
@@ -589,40 +1028,24 @@ void Tracing::PostUpdate(
         auto contacts = ecm.Component<gz::sim::components::ContactSensorData>(this->data_ptr->collision_entity);
         if(contacts != NULL)
         {
-            if(contacts->Data().contact_size() > 0)
-            {
-                err = modality_attr_val_set_string(&this->data_ptr->event_attrs[EID_IDX_NAME].val, EVENT_NAME_CONTACT);
-                this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-            }
-
             for(const auto &contact : contacts->Data().contact())
             {
                 if(contact.has_collision2())
                 {
                     auto other_col_entity = contact.collision2();
-                    auto other_name = gz::sim::scopedName(other_col_entity.id(), ecm, "::");
-
-                    err = modality_attr_val_set_string(&this->data_ptr->event_attrs[EID_IDX_COLLISION_NAME].val, other_name.c_str());
-                    this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-
-                    struct modality_big_int other_col_entity_id;
-                    err = modality_big_int_set(&other_col_entity_id, other_col_entity.id(), 0);
-                    this->data_ptr->HandleClientError(err, "Failed to set contact collision entity big int value");
-
-                    err = modality_attr_val_set_big_int(&this->data_ptr->event_attrs[EID_IDX_COLLISION_ENTITY].val, &other_col_entity_id);
-                    this->data_ptr->HandleClientError(err, ERR_EVENT_ATTR_VAL);
-
-                    err = modality_ingest_client_event(
-                            this->data_ptr->client,
-                            this->data_ptr->ordering,
-                            0,
-                            &this->data_ptr->event_attrs[EID_IDX_COLLISION_NAME],
-                            NUM_EVENT_ATTRS_CONTACT);
-                    this->data_ptr->HandleClientError(err, ERR_EVENT_SEND);
+                    PendingEvent &ev = this->data_ptr->NextEvent();
+                    ev.name = EVENT_NAME_CONTACT;
+                    ev.collision_name = gz::sim::scopedName(other_col_entity.id(), ecm, "::");
+                    ev.other_collision_entity = other_col_entity.id();
+                    ev.first_attr = EID_IDX_COLLISION_NAME;
+                    ev.num_attrs = NUM_EVENT_ATTRS_CONTACT;
+                    this->data_ptr->CommitEvent(ev);
 
                     this->data_ptr->ordering += 1;
                 }
             }
         }
     }
+
+    this->data_ptr->CheckBatchThresholds(info);
 }
@@ -0,0 +1,139 @@
+// Drives the tracing system through simulated steps against the mock ingest
+// client and reports sustained throughput, with and without batching. The
+// clock runs until the system has shut down, so events still queued for the
+// sender thread are included. Each config runs in its own process so the
+// peak RSS can be reported per config.
+//
+// Usage: modality_tracing_bench [steps] [event_cost_ns]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gz/sim/System.hh>
+
+#include "ModalityTracingPlugin.hh"
+#include "MockIngestClient.hh"
+
+#define NS_PER_SEC (1000000000ULL)
+
+static uint64_t cpu_ns(clockid_t clock)
+{
+    struct timespec ts;
+    (void) clock_gettime(clock, &ts);
+    return (((uint64_t) ts.tv_sec) * NS_PER_SEC) + (uint64_t) ts.tv_nsec;
+}
+
+struct Config
+{
+    const char *name;
+    const char *batch_n_steps;
+};
+
+static bool run(const Config &config, uint64_t steps)
+{
+    auto sdf = std::make_shared<sdf::Element>();
+    sdf->values["link_name"] = "chassis";
+    sdf->values["auth_token"] = "00";
+    sdf->values["step_size"] = "0.001";
+    if(config.batch_n_steps)
+    {
+        sdf->values["batch_n_steps"] = config.batch_n_steps;
+    }
+
+    gz::sim::EntityComponentManager ecm;
+    gz::sim::EventManager event_mngr;
+    mock_ingest::Reset();
+
+    auto system = std::make_unique<modality_gz::Tracing>();
+    system->Configure(1, sdf, ecm, event_mngr);
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    const uint64_t proc_start = cpu_ns(CLOCK_PROCESS_CPUTIME_ID);
+
+    gz::sim::UpdateInfo info;
+    info.dt = std::chrono::milliseconds(1);
+    for(uint64_t i = 1; i <= steps; i += 1)
+    {
+        info.iterations = i;
+        info.simTime += info.dt;
+        info.realTime += info.dt;
+        system->PostUpdate(info, ecm);
+    }
+
+    // Drains whatever is still queued for the sender
+    system.reset();
+
+    const double wall_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    const double proc_secs = (cpu_ns(CLOCK_PROCESS_CPUTIME_ID) - proc_start) / (double) NS_PER_SEC;
+
+    struct rusage usage;
+    (void) getrusage(RUSAGE_SELF, &usage);
+
+    const mock_ingest::Stats stats = mock_ingest::GetStats();
+    const bool ordered = (stats.ordering_errors == 0) && (stats.timestamp_errors == 0);
+    std::printf("%-20s %10llu %16.0f %16.0f %12.1f %10s\n",
+            config.name,
+            (unsigned long long) stats.events,
+            stats.events / wall_secs,
+            stats.events / proc_secs,
+            usage.ru_maxrss / 1024.0,
+            ordered ? "ok" : "FAILED");
+    std::fflush(stdout);
+
+    return (stats.events == (steps * 3)) && ordered;
+}
+
+int main(int argc, char **argv)
+{
+    const uint64_t steps = (argc > 1) ? std::strtoull(argv[1], NULL, 10) : 1000000;
+    const uint64_t event_cost_ns = (argc > 2) ? std::strtoull(argv[2], NULL, 10) : 0;
+    mock_ingest::SetEventCost(event_cost_ns);
+
+    const std::vector<Config> configs =
+    {
+        {"unbatched", NULL},
+        {"batch_n_steps=1", "1"},
+        {"batch_n_steps=10", "10"},
+        {"batch_n_steps=100", "100"},
+        {"batch_n_steps=1000", "1000"},
+    };
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    (void) sched_getaffinity(0, sizeof(cpus), &cpus);
+
+    std::printf("%llu steps at 1 kHz, pose + linear velocity + linear acceleration, %llu ns extra per event call, %d CPUs\n",
+            (unsigned long long) steps,
+            (unsigned long long) event_cost_ns,
+            CPU_COUNT(&cpus));
+    std::printf("%-20s %10s %16s %16s %12s %10s\n",
+            "config", "events", "wall events/s", "CPU events/s", "peak RSS MB", "ordering");
+    std::fflush(stdout);
+
+    bool ok = true;
+    for(const auto &config : configs)
+    {
+        const pid_t pid = fork();
+        if(pid == 0)
+        {
+            _exit(run(config, steps) ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+
+        int status = 0;
+        ok = (pid > 0) && (waitpid(pid, &status, 0) == pid)
+            && WIFEXITED(status) && (WEXITSTATUS(status) == EXIT_SUCCESS) && ok;
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,299 @@
+// Checks each batch flush trigger and the client error paths of the tracing
+// system against the mock ingest client. Every check also verifies that the
+// events reaching the client have gap-free ordering and non-decreasing
+// timestamps.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/sim/System.hh>
+
+#include "ModalityTracingPlugin.hh"
+#include "MockIngestClient.hh"
+
+// Entity the mock link reports for its collision
+#define COLLISION_ENTITY (3)
+
+namespace
+{
+using Config = std::map<std::string, std::string>;
+
+class Harness
+{
+    public: explicit Harness(const Config &config)
+    {
+        mock_ingest::Reset();
+
+        auto sdf = std::make_shared<sdf::Element>();
+        sdf->values["link_name"] = "chassis";
+        sdf->values["auth_token"] = "00";
+        for(const auto &kv : config)
+        {
+            sdf->values[kv.first] = kv.second;
+        }
+
+        this->system = std::make_unique<modality_gz::Tracing>();
+        this->system->Configure(1, sdf, this->ecm, this->event_mngr);
+        this->info.dt = std::chrono::milliseconds(1);
+    }
+
+    public: void Step(uint64_t n = 1)
+    {
+        for(uint64_t i = 0; i < n; i += 1)
+        {
+            this->info.iterations += 1;
+            this->info.simTime += this->info.dt;
+            this->info.realTime += this->info.dt;
+            this->system->PostUpdate(this->info, this->ecm);
+        }
+    }
+
+    public: void Update(void)
+    {
+        this->system->PostUpdate(this->info, this->ecm);
+    }
+
+    // Runs DeInit through the destructor
+    public: void Shutdown(void)
+    {
+        this->system.reset();
+    }
+
+    public: gz::sim::EntityComponentManager ecm;
+    public: gz::sim::EventManager event_mngr;
+    public: gz::sim::UpdateInfo info;
+    public: std::unique_ptr<modality_gz::Tracing> system;
+};
+
+// Events are sent from the sender thread, give it a chance to catch up
+bool WaitForEvents(uint64_t n)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(mock_ingest::GetStats().events < n)
+    {
+        if(std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// Long enough for the sender thread to have sent anything it was handed
+bool HeldBack(uint64_t n)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return mock_ingest::GetStats().events == n;
+}
+
+bool Ordered(void)
+{
+    const mock_ingest::Stats stats = mock_ingest::GetStats();
+    return (stats.ordering_errors == 0) && (stats.timestamp_errors == 0);
+}
+
+bool CheckUnbatched(void)
+{
+    Harness h(Config{});
+    h.Step();
+    bool ok = mock_ingest::GetStats().events == 3;
+    h.Step(9);
+    ok = ok && (mock_ingest::GetStats().events == 30);
+    h.Shutdown();
+    return ok && Ordered();
+}
+
+bool CheckBatchNSteps(void)
+{
+    Harness h(Config{{"batch_n_steps", "5"}});
+    h.Step(5);
+    bool ok = HeldBack(0);
+    // Iteration 6 is 5 past the first batched iteration, the batch is sent
+    // before the step's own events are recorded
+    h.Step();
+    ok = ok && WaitForEvents(15) && HeldBack(15);
+    h.Shutdown();
+    return ok && (mock_ingest::GetStats().events == 18) && Ordered();
+}
+
+bool CheckBatchMaxBytes(void)
+{
+    bool ok;
+    {
+        Harness h(Config{{"batch_max_bytes", "1"}});
+        h.Step();
+        ok = WaitForEvents(3);
+        h.Step();
+        ok = ok && WaitForEvents(6);
+        h.Shutdown();
+        ok = ok && Ordered();
+    }
+    {
+        Harness h(Config{{"batch_max_bytes", "1000000000"}});
+        h.Step(10);
+        ok = ok && HeldBack(0);
+        h.Shutdown();
+        ok = ok && (mock_ingest::GetStats().events == 30) && Ordered();
+    }
+    return ok;
+}
+
+bool CheckBatchMaxSimTime(void)
+{
+    Harness h(Config{{"batch_max_sim_time", "0.01"}});
+    h.Step(10);
+    bool ok = HeldBack(0);
+    // 10 ms past the first batched step
+    h.Step();
+    ok = ok && WaitForEvents(30) && HeldBack(30);
+    h.Shutdown();
+    return ok && (mock_ingest::GetStats().events == 33) && Ordered();
+}
+
+bool CheckDeadlineOnSampledOutSteps(void)
+{
+    // Only the first iteration is traced, the deadline still has to fire on
+    // the steps that are sampled out
+    Harness h(Config{{"batch_max_sim_time", "0.01"}, {"sample_n_iters", "1000"}});
+    h.Step();
+    bool ok = HeldBack(0);
+    h.Step(10);
+    ok = ok && WaitForEvents(3);
+    h.Shutdown();
+    return ok && (mock_ingest::GetStats().events == 3) && Ordered();
+}
+
+bool CheckPausedFlush(void)
+{
+    Harness h(Config{{"batch_n_steps", "1000"}});
+    h.Step(3);
+    bool ok = HeldBack(0);
+    h.info.paused = true;
+    h.Update();
+    ok = ok && WaitForEvents(9);
+    h.Shutdown();
+    return ok && (mock_ingest::GetStats().events == 9) && Ordered();
+}
+
+bool CheckRewindFlush(void)
+{
+    Harness h(Config{{"batch_n_steps", "1000"}});
+    h.Step(5);
+    bool ok = HeldBack(0);
+
+    // World reset, sim time and iterations start over
+    h.info.iterations = 0;
+    h.info.simTime = std::chrono::steady_clock::duration::zero();
+    h.Step();
+    ok = ok && WaitForEvents(15) && HeldBack(15);
+
+    // The step after the reset starts a new batch
+    h.Shutdown();
+    return ok && (mock_ingest::GetStats().events == 18) && Ordered();
+}
+
+bool CheckContacts(const Config &batching)
+{
+    Config config = batching;
+    config["contact_collision"] = "true";
+    Harness h(config);
+
+    gz::sim::components::Contact with_other;
+    with_other.has_other = true;
+    h.ecm.contact_entity = COLLISION_ENTITY;
+    with_other.other.entity = 7;
+    h.ecm.contact_data.data.contacts.push_back(with_other);
+    with_other.other.entity = 8;
+    h.ecm.contact_data.data.contacts.push_back(with_other);
+    // No other collision, doesn't produce an event
+    h.ecm.contact_data.data.contacts.push_back(gz::sim::components::Contact());
+
+    h.Step(2);
+    h.Shutdown();
+
+    const mock_ingest::Stats stats = mock_ingest::GetStats();
+    const std::vector<std::string> expected = {"entity_7", "entity_8", "entity_7", "entity_8"};
+    return (stats.events == 10) && (stats.collision_names == expected) && Ordered();
+}
+
+bool CheckSenderFailure(void)
+{
+    Harness h(Config{{"batch_n_steps", "2"}});
+    mock_ingest::FailEventsAfter(10);
+
+    // Keep stepping until the sender has hit the failure and PostUpdate has
+    // torn the client down
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(mock_ingest::GetStats().client_frees == 0)
+    {
+        if(std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        h.Step();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const mock_ingest::Stats failed = mock_ingest::GetStats();
+    h.Step(100);
+    const mock_ingest::Stats after = mock_ingest::GetStats();
+
+    // Sending stopped at the first failure and DeInit ran once
+    return (failed.events == 10)
+        && (failed.event_attempts == 11)
+        && (after.event_attempts == 11)
+        && (after.client_frees == 1)
+        && Ordered();
+}
+
+bool CheckUnbatchedFailure(void)
+{
+    Harness h(Config{});
+    mock_ingest::FailEventsAfter(4);
+    h.Step(10);
+
+    // Fails on the second event of the second step, DeInit stops the rest
+    const mock_ingest::Stats stats = mock_ingest::GetStats();
+    return (stats.events == 4)
+        && (stats.event_attempts == 5)
+        && (stats.client_frees == 1)
+        && Ordered();
+}
+}
+
+int main(void)
+{
+    const std::vector<std::pair<const char *, std::function<bool(void)>>> checks =
+    {
+        {"unbatched", CheckUnbatched},
+        {"batch_n_steps", CheckBatchNSteps},
+        {"batch_max_bytes", CheckBatchMaxBytes},
+        {"batch_max_sim_time", CheckBatchMaxSimTime},
+        {"deadline on sampled out steps", CheckDeadlineOnSampledOutSteps},
+        {"paused flush", CheckPausedFlush},
+        {"rewind flush", CheckRewindFlush},
+        {"contacts unbatched", []{ return CheckContacts({}); }},
+        {"contacts batched", []{ return CheckContacts({{"batch_n_steps", "1000"}}); }},
+        {"sender failure", CheckSenderFailure},
+        {"unbatched failure", CheckUnbatchedFailure},
+    };
+
+    int failures = 0;
+    for(const auto &check : checks)
+    {
+        const bool ok = check.second();
+        std::printf("%-32s %s\n", check.first, ok ? "ok" : "FAILED");
+        failures += ok ? 0 : 1;
+    }
+
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,241 @@
+// Stand-in for the Modality ingest client C API. Each event is encoded into a
+// small buffer and written to /dev/null with one write(2), mirroring the
+// per-event message the real client writes to its connection, optionally
+// followed by a fixed amount of busy CPU time. Events are
+// checked for gap-free ordering and non-decreasing timestamps. Stats are
+// locked since events may be sent from the plugin's sender thread.
+
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "modality/error.h"
+#include "modality/types.hpp"
+#include "modality/runtime.hpp"
+#include "modality/ingest_client.hpp"
+
+#include "MockIngestClient.hh"
+
+struct modality_runtime
+{
+};
+
+struct modality_ingest_client
+{
+    int fd{-1};
+    uint64_t next_ordering{0};
+    uint64_t last_timestamp{0};
+};
+
+static std::mutex stats_mutex;
+static mock_ingest::Stats stats;
+static uint64_t event_cost_ns = 0;
+static uint64_t fail_events_after = 0;
+
+static uint64_t thread_cpu_ns(void)
+{
+    struct timespec ts;
+    (void) clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (((uint64_t) ts.tv_sec) * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+void mock_ingest::Reset(void)
+{
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    stats = mock_ingest::Stats();
+    fail_events_after = 0;
+}
+
+void mock_ingest::SetEventCost(uint64_t ns)
+{
+    event_cost_ns = ns;
+}
+
+void mock_ingest::FailEventsAfter(uint64_t n)
+{
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    fail_events_after = n;
+}
+
+mock_ingest::Stats mock_ingest::GetStats(void)
+{
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    return stats;
+}
+
+int modality_attr_val_set_string(modality_attr_val *attr, const char *val)
+{
+    attr->tag = MODALITY_ATTR_TYPE_STRING;
+    attr->string = val;
+    return MODALITY_ERROR_OK;
+}
+
+int modality_attr_val_set_float(modality_attr_val *attr, double val)
+{
+    attr->tag = MODALITY_ATTR_TYPE_FLOAT;
+    attr->float_ = val;
+    return MODALITY_ERROR_OK;
+}
+
+int modality_attr_val_set_timestamp(modality_attr_val *attr, uint64_t val)
+{
+    attr->tag = MODALITY_ATTR_TYPE_TIMESTAMP;
+    attr->timestamp = val;
+    return MODALITY_ERROR_OK;
+}
+
+int modality_attr_val_set_big_int(modality_attr_val *attr, const modality_big_int *val)
+{
+    attr->tag = MODALITY_ATTR_TYPE_BIG_INT;
+    attr->big_int = *val;
+    return MODALITY_ERROR_OK;
+}
+
+int modality_big_int_set(modality_big_int *bi, uint64_t lower, uint64_t upper)
+{
+    bi->lower = lower;
+    bi->upper = upper;
+    return MODALITY_ERROR_OK;
+}
+
+int modality_timeline_id_init(modality_timeline_id *tid)
+{
+    std::memset(tid->uuid, 0xA5, sizeof(tid->uuid));
+    return MODALITY_ERROR_OK;
+}
+
+int modality_runtime_new(modality_runtime **rt)
+{
+    *rt = new modality_runtime();
+    return MODALITY_ERROR_OK;
+}
+
+void modality_runtime_free(modality_runtime *rt)
+{
+    delete rt;
+}
+
+int modality_ingest_client_new(modality_runtime *, modality_ingest_client **client)
+{
+    *client = new modality_ingest_client();
+    return MODALITY_ERROR_OK;
+}
+
+void modality_ingest_client_free(modality_ingest_client *client)
+{
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        stats.client_frees += 1;
+    }
+
+    if(client && (client->fd >= 0))
+    {
+        (void) close(client->fd);
+    }
+    delete client;
+}
+
+int modality_ingest_client_connect(modality_ingest_client *client, const char *, bool)
+{
+    client->fd = open("/dev/null", O_WRONLY);
+    return (client->fd >= 0) ? MODALITY_ERROR_OK : MODALITY_ERROR_NULL_POINTER;
+}
+
+int modality_ingest_client_authenticate(modality_ingest_client *, const char *)
+{
+    return MODALITY_ERROR_OK;
+}
+
+int modality_ingest_client_declare_attr_key(modality_ingest_client *, const char *, modality_attr_key *key)
+{
+    static modality_attr_key next_key = 1;
+    *key = next_key++;
+    return MODALITY_ERROR_OK;
+}
+
+int modality_ingest_client_open_timeline(modality_ingest_client *, const modality_timeline_id *)
+{
+    return MODALITY_ERROR_OK;
+}
+
+int modality_ingest_client_close_timeline(modality_ingest_client *)
+{
+    return MODALITY_ERROR_OK;
+}
+
+int modality_ingest_client_timeline_metadata(modality_ingest_client *, const modality_attr *, size_t)
+{
+    return MODALITY_ERROR_OK;
+}
+
+int modality_ingest_client_event(
+        modality_ingest_client *client,
+        uint64_t ordering_lower,
+        uint64_t,
+        const modality_attr *attrs,
+        size_t attrs_len)
+{
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    stats.event_attempts += 1;
+
+    if(!client || (client->fd < 0))
+    {
+        return MODALITY_ERROR_NULL_POINTER;
+    }
+
+    if((fail_events_after != 0) && (stats.events >= fail_events_after))
+    {
+        return MODALITY_ERROR_NULL_POINTER;
+    }
+
+    if(ordering_lower != client->next_ordering)
+    {
+        stats.ordering_errors += 1;
+    }
+    client->next_ordering = ordering_lower + 1;
+
+    // Contact events start with event.collision.name
+    if((attrs_len == 7) && (attrs[0].val.tag == MODALITY_ATTR_TYPE_STRING))
+    {
+        stats.collision_names.push_back(attrs[0].val.string);
+    }
+
+    unsigned char buf[512];
+    size_t len = 0;
+    std::memcpy(&buf[len], &ordering_lower, sizeof(ordering_lower));
+    len += sizeof(ordering_lower);
+    bool seen_timestamp = false;
+    for(size_t i = 0; (i < attrs_len) && ((len + sizeof(modality_attr)) <= sizeof(buf)); i += 1)
+    {
+        // The first timestamp attribute is event.timestamp
+        if((attrs[i].val.tag == MODALITY_ATTR_TYPE_TIMESTAMP) && !seen_timestamp)
+        {
+            seen_timestamp = true;
+            if(attrs[i].val.timestamp < client->last_timestamp)
+            {
+                stats.timestamp_errors += 1;
+            }
+            client->last_timestamp = attrs[i].val.timestamp;
+        }
+        std::memcpy(&buf[len], &attrs[i], sizeof(modality_attr));
+        len += sizeof(modality_attr);
+    }
+
+    if(write(client->fd, buf, len) != (ssize_t) len)
+    {
+        return MODALITY_ERROR_NULL_POINTER;
+    }
+
+    if(event_cost_ns != 0)
+    {
+        const uint64_t start = thread_cpu_ns();
+        while((thread_cpu_ns() - start) < event_cost_ns)
+        {
+        }
+    }
+
+    stats.events += 1;
+    return MODALITY_ERROR_OK;
+}
@@ -0,0 +1,35 @@
+#ifndef MOCK_INGEST_CLIENT_HH_
+#define MOCK_INGEST_CLIENT_HH_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mock_ingest
+{
+    struct Stats
+    {
+        uint64_t events{0};
+        uint64_t event_attempts{0};
+        uint64_t client_frees{0};
+        uint64_t ordering_errors{0};
+        uint64_t timestamp_errors{0};
+        // event.collision.name of each contact event, in send order
+        std::vector<std::string> collision_names;
+    };
+
+    // Clears the stats and injected failures, stats accumulate until the
+    // next reset
+    void Reset(void);
+
+    // Extra CPU time burned by each event call on top of the write(2),
+    // models the real client's serialization and runtime overhead
+    void SetEventCost(uint64_t ns);
+
+    // Fail every event call after the first n succeed, 0 never fails
+    void FailEventsAfter(uint64_t n);
+
+    Stats GetStats(void);
+}
+
+#endif /* MOCK_INGEST_CLIENT_HH_ */
@@ -0,0 +1,10 @@
+#ifndef MOCK_GZ_COMMON_CONSOLE_HH_
+#define MOCK_GZ_COMMON_CONSOLE_HH_
+
+#include <iostream>
+
+#define gzerr (std::cerr << "[Err] ")
+#define gzwarn (std::cerr << "[Wrn] ")
+#define gzmsg (std::cout << "[Msg] ")
+
+#endif /* MOCK_GZ_COMMON_CONSOLE_HH_ */
@@ -0,0 +1,17 @@
+#ifndef MOCK_GZ_COMMON_UUID_HH_
+#define MOCK_GZ_COMMON_UUID_HH_
+
+#include <string>
+
+namespace gz
+{
+    namespace common
+    {
+        class Uuid
+        {
+            public: std::string String() const { return "00000000-0000-0000-0000-000000000000"; }
+        };
+    }
+}
+
+#endif /* MOCK_GZ_COMMON_UUID_HH_ */
@@ -0,0 +1,40 @@
+#ifndef MOCK_GZ_MATH_HH_
+#define MOCK_GZ_MATH_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace gz
+{
+    namespace math
+    {
+        class Vector3d
+        {
+            public: double X() const { return this->x; }
+            public: double Y() const { return this->y; }
+            public: double Z() const { return this->z; }
+            public: double x{0.0}, y{0.0}, z{0.0};
+        };
+
+        class Pose3d
+        {
+            public: double X() const { return this->pos.x; }
+            public: double Y() const { return this->pos.y; }
+            public: double Z() const { return this->pos.z; }
+            public: double Roll() const { return this->rot.x; }
+            public: double Pitch() const { return this->rot.y; }
+            public: double Yaw() const { return this->rot.z; }
+            public: Vector3d pos;
+            public: Vector3d rot;
+        };
+
+        inline std::pair<int64_t, int64_t> durationToSecNsec(const std::chrono::steady_clock::duration &dur)
+        {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(dur).count();
+            return {ns / 1000000000, ns % 1000000000};
+        }
+    }
+}
+
+#endif /* MOCK_GZ_MATH_HH_ */
@@ -0,0 +1,7 @@
+#ifndef MOCK_GZ_PLUGIN_REGISTER_HH_
+#define MOCK_GZ_PLUGIN_REGISTER_HH_
+
+// The benchmark instantiates the system directly
+#define GZ_ADD_PLUGIN(...)
+
+#endif /* MOCK_GZ_PLUGIN_REGISTER_HH_ */
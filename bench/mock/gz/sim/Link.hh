@@ -0,0 +1,35 @@
+#ifndef MOCK_GZ_SIM_LINK_HH_
+#define MOCK_GZ_SIM_LINK_HH_
+
+#include <optional>
+#include <string>
+#include <gz/sim/System.hh>
+
+namespace gz
+{
+    namespace sim
+    {
+        // Always reports the same non-trivial kinematics
+        class Link
+        {
+            public: explicit Link(Entity) {}
+            public: void EnableVelocityChecks(EntityComponentManager &, bool) {}
+            public: void EnableAccelerationChecks(EntityComponentManager &, bool) {}
+            public: Entity CollisionByName(const EntityComponentManager &, const std::string &) const { return 3; }
+            public: std::optional<math::Pose3d> WorldPose(const EntityComponentManager &) const
+            {
+                return math::Pose3d{{1.0, 2.0, 3.0}, {0.1, 0.2, 0.3}};
+            }
+            public: std::optional<math::Vector3d> WorldLinearVelocity(const EntityComponentManager &) const
+            {
+                return math::Vector3d{0.5, 0.0, -0.5};
+            }
+            public: std::optional<math::Vector3d> WorldLinearAcceleration(const EntityComponentManager &) const
+            {
+                return math::Vector3d{0.0, 0.0, -9.8};
+            }
+        };
+    }
+}
+
+#endif /* MOCK_GZ_SIM_LINK_HH_ */
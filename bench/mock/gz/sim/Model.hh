@@ -0,0 +1,20 @@
+#ifndef MOCK_GZ_SIM_MODEL_HH_
+#define MOCK_GZ_SIM_MODEL_HH_
+
+#include <string>
+#include <gz/sim/System.hh>
+
+namespace gz
+{
+    namespace sim
+    {
+        class Model
+        {
+            public: explicit Model(Entity) {}
+            public: Entity LinkByName(const EntityComponentManager &, const std::string &) const { return 2; }
+            public: bool Static(const EntityComponentManager &) const { return false; }
+        };
+    }
+}
+
+#endif /* MOCK_GZ_SIM_MODEL_HH_ */
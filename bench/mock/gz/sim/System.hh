@@ -0,0 +1,103 @@
+#ifndef MOCK_GZ_SIM_SYSTEM_HH_
+#define MOCK_GZ_SIM_SYSTEM_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/math.hh>
+#include <sdf/Element.hh>
+
+namespace gz
+{
+    namespace sim
+    {
+        using Entity = uint64_t;
+        const Entity kNullEntity = 0;
+
+        struct UpdateInfo
+        {
+            std::chrono::steady_clock::duration simTime{0};
+            std::chrono::steady_clock::duration realTime{0};
+            std::chrono::steady_clock::duration dt{0};
+            uint64_t iterations{0};
+            bool paused{false};
+        };
+
+        class EventManager {};
+
+        namespace components
+        {
+            struct ContactEntity
+            {
+                uint64_t id() const { return this->entity; }
+                uint64_t entity{0};
+            };
+
+            struct Contact
+            {
+                bool has_collision2() const { return this->has_other; }
+                const ContactEntity &collision2() const { return this->other; }
+                bool has_other{false};
+                ContactEntity other;
+            };
+
+            struct Contacts
+            {
+                const std::vector<Contact> &contact() const { return this->contacts; }
+                int contact_size() const { return (int) this->contacts.size(); }
+                std::vector<Contact> contacts;
+            };
+
+            struct ContactSensorData
+            {
+                const Contacts &Data() const { return this->data; }
+                Contacts data;
+            };
+        }
+
+        // Only knows about the contact sensor data of a single collision
+        class EntityComponentManager
+        {
+            public: template<typename T> const T *Component(Entity) const { return nullptr; }
+
+            public: Entity contact_entity{kNullEntity};
+            public: components::ContactSensorData contact_data;
+        };
+
+        template<> inline const components::ContactSensorData *
+        EntityComponentManager::Component<components::ContactSensorData>(Entity entity) const
+        {
+            return ((entity != kNullEntity) && (entity == this->contact_entity)) ? &this->contact_data : nullptr;
+        }
+
+        class System
+        {
+            public: virtual ~System() = default;
+        };
+
+        class ISystemConfigure
+        {
+            public: virtual ~ISystemConfigure() = default;
+            public: virtual void Configure(
+                            const Entity &entity,
+                            const std::shared_ptr<const sdf::Element> &sdf,
+                            EntityComponentManager &ecm,
+                            EventManager &event_mngr) = 0;
+        };
+
+        class ISystemPostUpdate
+        {
+            public: virtual ~ISystemPostUpdate() = default;
+            public: virtual void PostUpdate(
+                            const UpdateInfo &info,
+                            const EntityComponentManager &ecm) = 0;
+        };
+    }
+}
+
+#endif /* MOCK_GZ_SIM_SYSTEM_HH_ */
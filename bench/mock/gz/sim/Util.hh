@@ -0,0 +1,18 @@
+#ifndef MOCK_GZ_SIM_UTIL_HH_
+#define MOCK_GZ_SIM_UTIL_HH_
+
+#include <string>
+#include <gz/sim/System.hh>
+
+namespace gz
+{
+    namespace sim
+    {
+        inline std::string scopedName(const Entity &entity, const EntityComponentManager &, const std::string & = "/", bool = true)
+        {
+            return "entity_" + std::to_string(entity);
+        }
+    }
+}
+
+#endif /* MOCK_GZ_SIM_UTIL_HH_ */
@@ -0,0 +1,3 @@
+#ifndef MOCK_GZ_SIM_COMPONENTS_COLLISION_HH_
+#define MOCK_GZ_SIM_COMPONENTS_COLLISION_HH_
+#endif /* MOCK_GZ_SIM_COMPONENTS_COLLISION_HH_ */
@@ -0,0 +1,3 @@
+#ifndef MOCK_GZ_SIM_COMPONENTS_CONTACT_SENSOR_HH_
+#define MOCK_GZ_SIM_COMPONENTS_CONTACT_SENSOR_HH_
+#endif /* MOCK_GZ_SIM_COMPONENTS_CONTACT_SENSOR_HH_ */
@@ -0,0 +1,7 @@
+#ifndef MOCK_GZ_SIM_COMPONENTS_CONTACT_SENSOR_DATA_HH_
+#define MOCK_GZ_SIM_COMPONENTS_CONTACT_SENSOR_DATA_HH_
+
+// The mock component lives next to the mock ECM that hands it out
+#include <gz/sim/System.hh>
+
+#endif /* MOCK_GZ_SIM_COMPONENTS_CONTACT_SENSOR_DATA_HH_ */
@@ -0,0 +1,7 @@
+#ifndef MOCK_MODALITY_ERROR_H_
+#define MOCK_MODALITY_ERROR_H_
+
+#define MODALITY_ERROR_OK (0)
+#define MODALITY_ERROR_NULL_POINTER (-1)
+
+#endif /* MOCK_MODALITY_ERROR_H_ */
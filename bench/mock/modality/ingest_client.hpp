@@ -0,0 +1,30 @@
+#ifndef MOCK_MODALITY_INGEST_CLIENT_HPP_
+#define MOCK_MODALITY_INGEST_CLIENT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "modality/types.hpp"
+#include "modality/runtime.hpp"
+
+struct modality_ingest_client;
+
+extern "C"
+{
+int modality_ingest_client_new(modality_runtime *rt, modality_ingest_client **client);
+void modality_ingest_client_free(modality_ingest_client *client);
+int modality_ingest_client_connect(modality_ingest_client *client, const char *url, bool allow_insecure_tls);
+int modality_ingest_client_authenticate(modality_ingest_client *client, const char *auth_token);
+int modality_ingest_client_declare_attr_key(modality_ingest_client *client, const char *key_name, modality_attr_key *key);
+int modality_ingest_client_open_timeline(modality_ingest_client *client, const modality_timeline_id *tid);
+int modality_ingest_client_close_timeline(modality_ingest_client *client);
+int modality_ingest_client_timeline_metadata(modality_ingest_client *client, const modality_attr *attrs, size_t attrs_len);
+int modality_ingest_client_event(
+        modality_ingest_client *client,
+        uint64_t ordering_lower,
+        uint64_t ordering_upper,
+        const modality_attr *attrs,
+        size_t attrs_len);
+}
+
+#endif /* MOCK_MODALITY_INGEST_CLIENT_HPP_ */
@@ -0,0 +1,12 @@
+#ifndef MOCK_MODALITY_RUNTIME_HPP_
+#define MOCK_MODALITY_RUNTIME_HPP_
+
+struct modality_runtime;
+
+extern "C"
+{
+int modality_runtime_new(modality_runtime **rt);
+void modality_runtime_free(modality_runtime *rt);
+}
+
+#endif /* MOCK_MODALITY_RUNTIME_HPP_ */
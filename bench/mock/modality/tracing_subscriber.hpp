@@ -0,0 +1,3 @@
+#ifndef MOCK_MODALITY_TRACING_SUBSCRIBER_HPP_
+#define MOCK_MODALITY_TRACING_SUBSCRIBER_HPP_
+#endif /* MOCK_MODALITY_TRACING_SUBSCRIBER_HPP_ */
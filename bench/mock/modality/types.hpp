@@ -0,0 +1,59 @@
+#ifndef MOCK_MODALITY_TYPES_HPP_
+#define MOCK_MODALITY_TYPES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace modality {}
+
+struct modality_big_int
+{
+    uint64_t lower;
+    uint64_t upper;
+};
+
+enum modality_attr_type
+{
+    MODALITY_ATTR_TYPE_NONE,
+    MODALITY_ATTR_TYPE_STRING,
+    MODALITY_ATTR_TYPE_FLOAT,
+    MODALITY_ATTR_TYPE_BIG_INT,
+    MODALITY_ATTR_TYPE_TIMESTAMP,
+};
+
+struct modality_attr_val
+{
+    modality_attr_type tag;
+    union
+    {
+        const char *string;
+        double float_;
+        modality_big_int big_int;
+        uint64_t timestamp;
+    };
+};
+
+typedef uint32_t modality_attr_key;
+
+struct modality_attr
+{
+    modality_attr_key key;
+    modality_attr_val val;
+};
+
+struct modality_timeline_id
+{
+    uint8_t uuid[16];
+};
+
+extern "C"
+{
+int modality_attr_val_set_string(modality_attr_val *attr, const char *val);
+int modality_attr_val_set_float(modality_attr_val *attr, double val);
+int modality_attr_val_set_timestamp(modality_attr_val *attr, uint64_t val);
+int modality_attr_val_set_big_int(modality_attr_val *attr, const modality_big_int *val);
+int modality_big_int_set(modality_big_int *bi, uint64_t lower, uint64_t upper);
+int modality_timeline_id_init(modality_timeline_id *tid);
+}
+
+#endif /* MOCK_MODALITY_TYPES_HPP_ */
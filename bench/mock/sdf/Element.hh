@@ -0,0 +1,51 @@
+#ifndef MOCK_SDF_ELEMENT_HH_
+#define MOCK_SDF_ELEMENT_HH_
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace sdf
+{
+    // Flat key/value stand-in for the plugin's SDF element
+    class Element
+    {
+        public: std::map<std::string, std::string> values;
+
+        public: bool HasElement(const std::string &key) const
+        {
+            return this->values.count(key) != 0;
+        }
+
+        public: template<typename T> T Get(const std::string &key) const
+        {
+            return this->Get<T>(key, T()).first;
+        }
+
+        public: template<typename T> std::pair<T, bool> Get(const std::string &key, const T &default_value) const
+        {
+            auto it = this->values.find(key);
+            if(it == this->values.end())
+            {
+                return {default_value, false};
+            }
+            T value;
+            std::istringstream is(it->second);
+            is >> std::boolalpha >> value;
+            return {value, true};
+        }
+    };
+
+    template<> inline std::pair<std::string, bool> Element::Get(const std::string &key, const std::string &default_value) const
+    {
+        auto it = this->values.find(key);
+        if(it == this->values.end())
+        {
+            return {default_value, false};
+        }
+        return {it->second, true};
+    }
+}
+
+#endif /* MOCK_SDF_ELEMENT_HH_ */